@@ -131,6 +131,344 @@ static inline int128_win int128_win_divide(int128_win dividend, int128_win divis
   return (int128_win) { .low = uquotient.low, .high = quotient_high };
 }
 
+static inline void int128_win_add_inplace(int128_win* INT128_WIN_RESTRICT acc, const int128_win* INT128_WIN_RESTRICT value) {
+  uint64_t high = 0;
+  unsigned char carry = _addcarry_u64(0, acc->low, value->low, &acc->low);
+  _addcarry_u64(carry, (uint64_t) acc->high, (uint64_t) value->high, &high);
+  acc->high = int128_win_bitcast_to_signed(high);
+}
+
+static inline void int128_win_add_int64_inplace(int128_win* INT128_WIN_RESTRICT acc, int64_t value) {
+  uint64_t value_high = ((uint64_t) 0) - (((uint64_t) value) >> 63);
+  uint64_t high = 0;
+  unsigned char carry = _addcarry_u64(0, acc->low, (uint64_t) value, &acc->low);
+  _addcarry_u64(carry, (uint64_t) acc->high, value_high, &high);
+  acc->high = int128_win_bitcast_to_signed(high);
+}
+
+static inline void int128_win_subtract_inplace(int128_win* INT128_WIN_RESTRICT acc, const int128_win* INT128_WIN_RESTRICT value) {
+  uint64_t high = 0;
+  unsigned char borrow = _subborrow_u64(0, acc->low, value->low, &acc->low);
+  _subborrow_u64(borrow, (uint64_t) acc->high, (uint64_t) value->high, &high);
+  acc->high = int128_win_bitcast_to_signed(high);
+}
+
+static inline void int128_win_multiply_inplace(int128_win* INT128_WIN_RESTRICT acc, const int128_win* INT128_WIN_RESTRICT value) {
+  uint64_t carry = 0;
+  uint64_t low = _umul128(acc->low, value->low, &carry);
+  uint64_t high = (acc->low * (uint64_t) value->high) + ((uint64_t) acc->high * value->low) + carry;
+  acc->low = low;
+  acc->high = int128_win_bitcast_to_signed(high);
+}
+
+static inline void int128_win_divide_inplace(int128_win* INT128_WIN_RESTRICT dividend, const int128_win* INT128_WIN_RESTRICT divisor,
+    int128_win* INT128_WIN_RESTRICT remainder) {
+  *dividend = int128_win_divide(*dividend, *divisor, remainder);
+}
+
+static inline uint128_win int128_win_gcd(int128_win left, int128_win right) {
+  // Result is returned as unsigned because gcd(Int128Min(), 0) is not
+  // representable as a signed value.
+  uint128_win uleft = int128_win_unsigned_absolute_value(left);
+  uint128_win uright = int128_win_unsigned_absolute_value(right);
+  return uint128_win_gcd(uleft, uright);
+}
+
+static inline int int128_win_lcm(int128_win left, int128_win right, int128_win* result) {
+  if (NULL == result) {
+    return -1;
+  }
+  uint128_win uleft = int128_win_unsigned_absolute_value(left);
+  uint128_win uright = int128_win_unsigned_absolute_value(right);
+  uint128_win ures = { .low = 0, .high = 0 };
+  int err = uint128_win_lcm(uleft, uright, &ures);
+  if (0 != err) {
+    return err;
+  }
+  if (ures.high & (((uint64_t) 1) << 63)) {
+    return 1;
+  }
+  *result = (int128_win) { .low = ures.low, .high = (int64_t) ures.high };
+  return 0;
+}
+
+static inline int128_win int128_win_mul_add_int64(int128_win acc, int64_t left, int64_t right) {
+  int64_t prod_high = 0;
+  uint64_t prod_low = (uint64_t) _mul128(left, right, &prod_high);
+  uint64_t low = 0;
+  uint64_t high = 0;
+  unsigned char carry = _addcarry_u64(0, acc.low, prod_low, &low);
+  _addcarry_u64(carry, (uint64_t) acc.high, (uint64_t) prod_high, &high);
+  return (int128_win) { .low = low, .high = int128_win_bitcast_to_signed(high) };
+}
+
+static inline int int128_win_mul_add_int64_checked(int128_win acc, int64_t left, int64_t right, int128_win* result) {
+  if (NULL == result) {
+    return -1;
+  }
+  int64_t prod_high = 0;
+  uint64_t prod_low = (uint64_t) _mul128(left, right, &prod_high);
+  uint64_t low = 0;
+  uint64_t high = 0;
+  unsigned char carry = _addcarry_u64(0, acc.low, prod_low, &low);
+  _addcarry_u64(carry, (uint64_t) acc.high, (uint64_t) prod_high, &high);
+  int64_t sum_high = int128_win_bitcast_to_signed(high);
+  // Product of two int64 values always fits, so only the addition can
+  // overflow, that happens when both addends have the same sign and
+  // the sign of the sum differs from it.
+  if ((acc.high < 0) == (prod_high < 0) && (sum_high < 0) != (acc.high < 0)) {
+    return 1;
+  }
+  *result = (int128_win) { .low = low, .high = sum_high };
+  return 0;
+}
+
+static inline int128_win int128_win_dot_int64(const int64_t* left, const int64_t* right, size_t count) {
+  // Independent accumulators let the multiplies of the subsequent
+  // pairs overlap instead of waiting on a single carry chain.
+  uint64_t low[4] = { 0, 0, 0, 0 };
+  uint64_t high[4] = { 0, 0, 0, 0 };
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    for (size_t j = 0; j < 4; j++) {
+      int64_t prod_high = 0;
+      uint64_t prod_low = (uint64_t) _mul128(left[i + j], right[i + j], &prod_high);
+      unsigned char carry = _addcarry_u64(0, low[j], prod_low, &low[j]);
+      _addcarry_u64(carry, high[j], (uint64_t) prod_high, &high[j]);
+    }
+  }
+  for (; i < count; i++) {
+    int64_t prod_high = 0;
+    uint64_t prod_low = (uint64_t) _mul128(left[i], right[i], &prod_high);
+    unsigned char carry = _addcarry_u64(0, low[0], prod_low, &low[0]);
+    _addcarry_u64(carry, high[0], (uint64_t) prod_high, &high[0]);
+  }
+  for (size_t j = 1; j < 4; j++) {
+    unsigned char carry = _addcarry_u64(0, low[0], low[j], &low[0]);
+    _addcarry_u64(carry, high[0], high[j], &high[0]);
+  }
+  return (int128_win) { .low = low[0], .high = int128_win_bitcast_to_signed(high[0]) };
+}
+
+static inline int int128_win_dot_int64_checked(const int64_t* left, const int64_t* right, size_t count, int128_win* result) {
+  if (NULL == result || (count > 0 && (NULL == left || NULL == right))) {
+    return -1;
+  }
+  // Accumulates into 192-bit values, the extra word keeps the sign
+  // extension so intermediate overflows of the partial sums are harmless
+  // and only the final result is checked.
+  uint64_t low[4] = { 0, 0, 0, 0 };
+  uint64_t high[4] = { 0, 0, 0, 0 };
+  uint64_t ext[4] = { 0, 0, 0, 0 };
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    for (size_t j = 0; j < 4; j++) {
+      int64_t prod_high = 0;
+      uint64_t prod_low = (uint64_t) _mul128(left[i + j], right[i + j], &prod_high);
+      uint64_t prod_ext = ((uint64_t) 0) - (((uint64_t) prod_high) >> 63);
+      unsigned char carry = _addcarry_u64(0, low[j], prod_low, &low[j]);
+      carry = _addcarry_u64(carry, high[j], (uint64_t) prod_high, &high[j]);
+      _addcarry_u64(carry, ext[j], prod_ext, &ext[j]);
+    }
+  }
+  for (; i < count; i++) {
+    int64_t prod_high = 0;
+    uint64_t prod_low = (uint64_t) _mul128(left[i], right[i], &prod_high);
+    uint64_t prod_ext = ((uint64_t) 0) - (((uint64_t) prod_high) >> 63);
+    unsigned char carry = _addcarry_u64(0, low[0], prod_low, &low[0]);
+    carry = _addcarry_u64(carry, high[0], (uint64_t) prod_high, &high[0]);
+    _addcarry_u64(carry, ext[0], prod_ext, &ext[0]);
+  }
+  for (size_t j = 1; j < 4; j++) {
+    unsigned char carry = _addcarry_u64(0, low[0], low[j], &low[0]);
+    carry = _addcarry_u64(carry, high[0], high[j], &high[0]);
+    _addcarry_u64(carry, ext[0], ext[j], &ext[0]);
+  }
+  if (ext[0] != ((uint64_t) 0) - (high[0] >> 63)) {
+    return 1;
+  }
+  *result = (int128_win) { .low = low[0], .high = int128_win_bitcast_to_signed(high[0]) };
+  return 0;
+}
+
+static inline bool int128_win_less(int128_win left, int128_win right) {
+  // Branchless variant of compare for selection algorithms.
+  return (left.high < right.high) | ((left.high == right.high) & (left.low < right.low));
+}
+
+static inline void int128_win_swap(int128_win* left, int128_win* right) {
+  int128_win tmp = *left;
+  *left = *right;
+  *right = tmp;
+}
+
+static inline bool int128_win_top_k_worse(int128_win left, int128_win right, bool descending) {
+  return descending ? int128_win_less(left, right) : int128_win_less(right, left);
+}
+
+static inline void int128_win_top_k_sift_down(int128_win* heap, uint32_t* idx, size_t len, size_t pos, bool descending) {
+  // Heap keeps the worst of the selected values at its root.
+  for (;;) {
+    size_t child = 2 * pos + 1;
+    if (child >= len) {
+      break;
+    }
+    if (child + 1 < len && int128_win_top_k_worse(heap[child + 1], heap[child], descending)) {
+      child += 1;
+    }
+    if (!int128_win_top_k_worse(heap[child], heap[pos], descending)) {
+      break;
+    }
+    int128_win_swap(&heap[pos], &heap[child]);
+    if (NULL != idx) {
+      uint32_t tmp = idx[pos];
+      idx[pos] = idx[child];
+      idx[child] = tmp;
+    }
+    pos = child;
+  }
+}
+
+static inline int int128_win_top_k(const int128_win* values, size_t count, size_t k, bool descending,
+    int128_win* out, uint32_t* out_idx) {
+  if ((count > 0 && NULL == values) || (k > 0 && NULL == out)) {
+    return -1;
+  }
+  if (NULL != out_idx && count > UINT32_MAX) {
+    return -1;
+  }
+  size_t len = k < count ? k : count;
+  if (0 == len) {
+    return 0;
+  }
+
+  for (size_t i = 0; i < len; i++) {
+    out[i] = values[i];
+    if (NULL != out_idx) {
+      out_idx[i] = (uint32_t) i;
+    }
+  }
+  for (size_t i = len / 2; i > 0; i--) {
+    int128_win_top_k_sift_down(out, out_idx, len, i - 1, descending);
+  }
+
+  // Root of the heap is the current k-th threshold, most of the values
+  // on large inputs are rejected with a single comparison against it.
+  int128_win threshold = out[0];
+  for (size_t i = len; i < count; i++) {
+    if (!int128_win_top_k_worse(threshold, values[i], descending)) {
+      continue;
+    }
+    out[0] = values[i];
+    if (NULL != out_idx) {
+      out_idx[0] = (uint32_t) i;
+    }
+    int128_win_top_k_sift_down(out, out_idx, len, 0, descending);
+    threshold = out[0];
+  }
+
+  // Sorts selected values in place, the best one goes first.
+  for (size_t end = len - 1; end > 0; end--) {
+    int128_win_swap(&out[0], &out[end]);
+    if (NULL != out_idx) {
+      uint32_t tmp = out_idx[0];
+      out_idx[0] = out_idx[end];
+      out_idx[end] = tmp;
+    }
+    int128_win_top_k_sift_down(out, out_idx, end, 0, descending);
+  }
+  return 0;
+}
+
+static inline void int128_win_insertion_sort(int128_win* values, size_t count) {
+  for (size_t i = 1; i < count; i++) {
+    int128_win current = values[i];
+    size_t j = i;
+    while (j > 0 && int128_win_less(current, values[j - 1])) {
+      values[j] = values[j - 1];
+      j -= 1;
+    }
+    values[j] = current;
+  }
+}
+
+static inline int128_win int128_win_median_of_three(int128_win first, int128_win second, int128_win third) {
+  if (int128_win_less(second, first)) {
+    int128_win_swap(&first, &second);
+  }
+  if (int128_win_less(third, second)) {
+    second = third;
+  }
+  if (int128_win_less(second, first)) {
+    second = first;
+  }
+  return second;
+}
+
+static inline void int128_win_heap_select(int128_win* values, size_t count, size_t nth) {
+  // Max-heap over first nth + 1 values keeps the smallest of them,
+  // its root ends up being the nth value.
+  size_t len = nth + 1;
+  for (size_t i = len / 2; i > 0; i--) {
+    int128_win_top_k_sift_down(values, NULL, len, i - 1, false);
+  }
+  for (size_t i = len; i < count; i++) {
+    if (int128_win_less(values[i], values[0])) {
+      int128_win_swap(&values[0], &values[i]);
+      int128_win_top_k_sift_down(values, NULL, len, 0, false);
+    }
+  }
+  int128_win_swap(&values[0], &values[nth]);
+}
+
+static inline int int128_win_nth_element(int128_win* values, size_t count, size_t nth) {
+  if (NULL == values || nth >= count) {
+    return -1;
+  }
+
+  size_t begin = 0;
+  size_t end = count;
+  // Falls back to heap selection after 2 * log2(count) partition steps
+  // to guarantee O(n log n) in the worst case.
+  int depth_limit = 2 * (64 - uint128_win_count_leading_zeros(count));
+  while (end - begin > 16) {
+    if (0 == depth_limit) {
+      int128_win_heap_select(values + begin, end - begin, nth - begin);
+      return 0;
+    }
+    depth_limit -= 1;
+
+    int128_win pivot = int128_win_median_of_three(values[begin],
+        values[begin + (end - begin) / 2], values[end - 1]);
+    // Three-way partition keeps runs of duplicates, common in table
+    // columns, from degrading the selection.
+    size_t lt = begin;
+    size_t gt = end;
+    size_t i = begin;
+    while (i < gt) {
+      if (int128_win_less(values[i], pivot)) {
+        int128_win_swap(&values[lt], &values[i]);
+        lt += 1;
+        i += 1;
+      } else if (int128_win_less(pivot, values[i])) {
+        gt -= 1;
+        int128_win_swap(&values[i], &values[gt]);
+      } else {
+        i += 1;
+      }
+    }
+    if (nth < lt) {
+      end = lt;
+    } else if (nth >= gt) {
+      begin = gt;
+    } else {
+      return 0;
+    }
+  }
+  int128_win_insertion_sort(values + begin, end - begin);
+  return 0;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2023 alex@staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INT128_WIN_INT128_WIN_FOR_H
+#define INT128_WIN_INT128_WIN_FOR_H
+
+#include "int128_win.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif // __AVX2__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Frame-of-reference encoding: every block stores its minimal value as a base
+// and the offsets from it bit-packed at the minimal width that fits all of them.
+//
+// Offsets up to 64 bits wide are stored as a single packed stream. For wider
+// offsets the low 64 bits of every offset are stored as is, followed by a packed
+// stream of the remaining high bits.
+//
+// Every packed stream is followed by one padding word, so unpacking can always
+// read two adjacent words without bounds checks.
+
+#define INT128_WIN_FOR_BLOCK_SIZE 1024
+#define INT128_WIN_FOR_PACKED_WORDS_MAX (INT128_WIN_FOR_BLOCK_SIZE * 2 + 1)
+
+typedef struct int128_win_for_block {
+  int128_win base;
+  uint32_t count;
+  uint32_t width;
+} int128_win_for_block;
+
+static inline size_t int128_win_for_packed_words(size_t count, int width) {
+  if (width > 64) {
+    return count + ((count * (width - 64) + 63) / 64) + 1;
+  }
+  return ((count * width + 63) / 64) + 1;
+}
+
+static inline void int128_win_for_put_bits(uint64_t* packed, size_t pos, uint64_t value) {
+  size_t word = pos >> 6;
+  int shift = (int) (pos & 63);
+  packed[word] |= value << shift;
+  // Double shift avoids shifting by 64 when the value is word aligned.
+  packed[word + 1] |= (value >> 1) >> (63 - shift);
+}
+
+static inline uint64_t int128_win_for_get_bits(const uint64_t* packed, size_t pos, uint64_t mask) {
+  size_t word = pos >> 6;
+  int shift = (int) (pos & 63);
+  uint64_t value = (packed[word] >> shift) | ((packed[word + 1] << 1) << (63 - shift));
+  return value & mask;
+}
+
+static inline uint64_t int128_win_for_mask(int width) {
+  if (width >= 64) {
+    return UINT64_MAX;
+  }
+  return (((uint64_t) 1) << width) - 1;
+}
+
+static inline void int128_win_for_unpack64(const uint64_t* packed, size_t count, int width, uint64_t* out) {
+  if (0 == width) {
+    memset(out, 0, count * sizeof(uint64_t));
+    return;
+  }
+  uint64_t mask = int128_win_for_mask(width);
+  size_t i = 0;
+#ifdef __AVX2__
+  // Unpacks 4 values at a time using gathers and per-lane shifts, AVX2 shifts
+  // by 64 produce zero so no special casing for aligned values is needed.
+  const __m256i vmask = _mm256_set1_epi64x((long long) mask);
+  const __m256i vsixty_four = _mm256_set1_epi64x(64);
+  const __m256i vsixty_three = _mm256_set1_epi64x(63);
+  const __m256i vone = _mm256_set1_epi64x(1);
+  const __m256i vstep = _mm256_set1_epi64x(4 * (long long) width);
+  __m256i vpos = _mm256_set_epi64x(3 * (long long) width, 2 * (long long) width, (long long) width, 0);
+  for (; i + 4 <= count; i += 4) {
+    __m256i vword = _mm256_srli_epi64(vpos, 6);
+    __m256i vshift = _mm256_and_si256(vpos, vsixty_three);
+    __m256i vlow = _mm256_i64gather_epi64((const long long*) packed, vword, 8);
+    __m256i vhigh = _mm256_i64gather_epi64((const long long*) packed, _mm256_add_epi64(vword, vone), 8);
+    __m256i vres = _mm256_or_si256(_mm256_srlv_epi64(vlow, vshift),
+        _mm256_sllv_epi64(vhigh, _mm256_sub_epi64(vsixty_four, vshift)));
+    _mm256_storeu_si256((__m256i*) (out + i), _mm256_and_si256(vres, vmask));
+    vpos = _mm256_add_epi64(vpos, vstep);
+  }
+#endif // __AVX2__
+  for (; i < count; i++) {
+    out[i] = int128_win_for_get_bits(packed, i * width, mask);
+  }
+}
+
+static inline int128_win int128_win_for_add_offset(int128_win base, uint64_t offset_low, uint64_t offset_high) {
+  uint64_t low = 0;
+  uint64_t high = 0;
+  unsigned char carry = _addcarry_u64(0, base.low, offset_low, &low);
+  _addcarry_u64(carry, (uint64_t) base.high, offset_high, &high);
+  return (int128_win) { .low = low, .high = int128_win_bitcast_to_signed(high) };
+}
+
+// Packed buffer must have space for INT128_WIN_FOR_PACKED_WORDS_MAX words,
+// int128_win_for_packed_words() tells how many of them are used.
+static inline int int128_win_for_encode(const int128_win* values, size_t count,
+    int128_win_for_block* block, uint64_t* packed) {
+  if (NULL == block || NULL == packed || (count > 0 && NULL == values)) {
+    return -1;
+  }
+  if (count > INT128_WIN_FOR_BLOCK_SIZE) {
+    return 1;
+  }
+
+  int128_win base = { .low = 0, .high = 0 };
+  if (count > 0) {
+    base = values[0];
+  }
+  for (size_t i = 1; i < count; i++) {
+    if (int128_win_less(values[i], base)) {
+      base = values[i];
+    }
+  }
+  // Highest set bit of all offsets or-ed together is the one of the largest offset.
+  uint128_win ubase = { .low = base.low, .high = (uint64_t) base.high };
+  uint128_win offsets_or = { .low = 0, .high = 0 };
+  for (size_t i = 0; i < count; i++) {
+    uint128_win uvalue = { .low = values[i].low, .high = (uint64_t) values[i].high };
+    uint128_win offset = uint128_win_subtract(uvalue, ubase);
+    offsets_or.low |= offset.low;
+    offsets_or.high |= offset.high;
+  }
+  int width = uint128_win_last_set_bit_pos(offsets_or) + 1;
+
+  memset(packed, 0, int128_win_for_packed_words(count, width) * sizeof(uint64_t));
+  if (width > 64) {
+    uint64_t* packed_high = packed + count;
+    for (size_t i = 0; i < count; i++) {
+      uint128_win uvalue = { .low = values[i].low, .high = (uint64_t) values[i].high };
+      uint128_win offset = uint128_win_subtract(uvalue, ubase);
+      packed[i] = offset.low;
+      int128_win_for_put_bits(packed_high, i * (width - 64), offset.high);
+    }
+  } else if (width > 0) {
+    for (size_t i = 0; i < count; i++) {
+      uint64_t offset = values[i].low - base.low;
+      int128_win_for_put_bits(packed, i * width, offset);
+    }
+  }
+
+  block->base = base;
+  block->count = (uint32_t) count;
+  block->width = (uint32_t) width;
+  return 0;
+}
+
+static inline int int128_win_for_decode(const int128_win_for_block* block, const uint64_t* packed, int128_win* values) {
+  if (NULL == block || NULL == packed || NULL == values) {
+    return -1;
+  }
+  if (block->count > INT128_WIN_FOR_BLOCK_SIZE || block->width > 128) {
+    return 1;
+  }
+  size_t count = block->count;
+  int width = (int) block->width;
+  uint64_t offsets[INT128_WIN_FOR_BLOCK_SIZE];
+
+  if (width > 64) {
+    int128_win_for_unpack64(packed + count, count, width - 64, offsets);
+    for (size_t i = 0; i < count; i++) {
+      values[i] = int128_win_for_add_offset(block->base, packed[i], offsets[i]);
+    }
+  } else {
+    int128_win_for_unpack64(packed, count, width, offsets);
+    for (size_t i = 0; i < count; i++) {
+      values[i] = int128_win_for_add_offset(block->base, offsets[i], 0);
+    }
+  }
+  return 0;
+}
+
+// Random access to a single value, index must be less than block count.
+static inline int128_win int128_win_for_get(const int128_win_for_block* block, const uint64_t* packed, size_t index) {
+  int width = (int) block->width;
+  if (width > 64) {
+    uint64_t high = int128_win_for_get_bits(packed + block->count, index * (width - 64),
+        int128_win_for_mask(width - 64));
+    return int128_win_for_add_offset(block->base, packed[index], high);
+  }
+  if (0 == width) {
+    return block->base;
+  }
+  uint64_t low = int128_win_for_get_bits(packed, index * width, int128_win_for_mask(width));
+  return int128_win_for_add_offset(block->base, low, 0);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INT128_WIN_INT128_WIN_FOR_H
\ No newline at end of file
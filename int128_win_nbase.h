@@ -0,0 +1,220 @@
+/*
+ * Copyright 2023 alex@staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INT128_WIN_INT128_WIN_NBASE_H
+#define INT128_WIN_INT128_WIN_NBASE_H
+
+#include "int128_win.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Conversion to and from the digits layout of PostgreSQL NUMERIC: base 10000
+// digits, most significant first, weight is the power of NBASE of the first
+// digit, leading and trailing zero digits are not stored.
+
+#define INT128_WIN_NBASE 10000
+#define INT128_WIN_NBASE_DIGITS_MAX 10
+#define INT128_WIN_NBASE_POS 0x0000
+#define INT128_WIN_NBASE_NEG 0x4000
+
+// 10^16 shifted left to have its highest bit set and its reciprocal
+// floor((2^128 - 1) / d) - 2^64 for the division by invariant integer.
+#define INT128_WIN_NBASE_CHUNK 10000000000000000ULL
+#define INT128_WIN_NBASE_CHUNK_SHIFT 10
+#define INT128_WIN_NBASE_CHUNK_NORM 0x8e1bc9bf04000000ULL
+#define INT128_WIN_NBASE_CHUNK_RECIPROCAL 0xcd2b297d889bc2b6ULL
+
+static inline uint64_t int128_win_nbase_divide_2by1(uint64_t high, uint64_t low, uint64_t* remainder) {
+  // Division of a 2-word value by the normalized chunk, high must be less
+  // than the divisor. Based on "Improved division by invariant integers"
+  // by Moller and Granlund.
+  const uint64_t divisor = INT128_WIN_NBASE_CHUNK_NORM;
+  uint64_t q1 = 0;
+  uint64_t q0 = _umul128(INT128_WIN_NBASE_CHUNK_RECIPROCAL, high, &q1);
+  unsigned char carry = _addcarry_u64(0, q0, low, &q0);
+  _addcarry_u64(carry, q1, high + 1, &q1);
+  uint64_t rem = low - q1 * divisor;
+  if (rem > q0) {
+    q1 -= 1;
+    rem += divisor;
+  }
+  if (rem >= divisor) {
+    q1 += 1;
+    rem -= divisor;
+  }
+  *remainder = rem;
+  return q1;
+}
+
+static inline uint128_win int128_win_nbase_divide_chunk(uint128_win value, uint64_t* remainder) {
+  const int shift = INT128_WIN_NBASE_CHUNK_SHIFT;
+  uint64_t n2 = value.high >> (64 - shift);
+  uint64_t n1 = (value.high << shift) | (value.low >> (64 - shift));
+  uint64_t n0 = value.low << shift;
+  uint64_t rem = 0;
+  uint64_t high = int128_win_nbase_divide_2by1(n2, n1, &rem);
+  uint64_t low = int128_win_nbase_divide_2by1(rem, n0, &rem);
+  *remainder = rem >> shift;
+  return (uint128_win) { .low = low, .high = high };
+}
+
+// Digits must have space for INT128_WIN_NBASE_DIGITS_MAX values.
+static inline int uint128_win_to_nbase_digits(uint128_win value, int16_t* digits, int* ndigits, int* weight) {
+  if (NULL == digits || NULL == ndigits || NULL == weight) {
+    return -1;
+  }
+
+  // Splits value into 10^16 chunks, further splitting into NBASE
+  // digits is done with 64-bit math.
+  uint64_t chunks[3] = { 0, 0, 0 };
+  if (0 == value.high) {
+    chunks[0] = value.low % INT128_WIN_NBASE_CHUNK;
+    chunks[1] = value.low / INT128_WIN_NBASE_CHUNK;
+  } else {
+    uint128_win quotient = int128_win_nbase_divide_chunk(value, &chunks[0]);
+    quotient = int128_win_nbase_divide_chunk(quotient, &chunks[1]);
+    chunks[2] = quotient.low;
+  }
+
+  // Least significant digit goes first here.
+  int16_t reversed[12];
+  for (int i = 0; i < 3; i++) {
+    uint64_t chunk = chunks[i];
+    for (int j = 0; j < 4; j++) {
+      reversed[i * 4 + j] = (int16_t) (chunk % INT128_WIN_NBASE);
+      chunk /= INT128_WIN_NBASE;
+    }
+  }
+
+  int first = 11;
+  while (first >= 0 && 0 == reversed[first]) {
+    first -= 1;
+  }
+  if (first < 0) {
+    *ndigits = 0;
+    *weight = 0;
+    return 0;
+  }
+  int last = 0;
+  while (0 == reversed[last]) {
+    last += 1;
+  }
+  for (int i = first; i >= last; i--) {
+    digits[first - i] = reversed[i];
+  }
+  *ndigits = first - last + 1;
+  *weight = first;
+  return 0;
+}
+
+// Digits must have space for INT128_WIN_NBASE_DIGITS_MAX values.
+static inline int int128_win_to_nbase_digits(int128_win value, int16_t* digits, int* ndigits, int* weight, int* sign) {
+  if (NULL == sign) {
+    return -1;
+  }
+  uint128_win uvalue = int128_win_unsigned_absolute_value(value);
+  int err = uint128_win_to_nbase_digits(uvalue, digits, ndigits, weight);
+  if (0 != err) {
+    return err;
+  }
+  *sign = value.high < 0 ? INT128_WIN_NBASE_NEG : INT128_WIN_NBASE_POS;
+  return 0;
+}
+
+static inline int uint128_win_from_nbase_digits(const int16_t* digits, int ndigits, int weight, uint128_win* value_out) {
+  if ((ndigits > 0 && NULL == digits) || ndigits < 0 || NULL == value_out) {
+    return -1;
+  }
+  while (ndigits > 0 && 0 == digits[0]) {
+    digits += 1;
+    ndigits -= 1;
+    weight -= 1;
+  }
+  for (int i = 0; i < ndigits; i++) {
+    if (digits[i] < 0 || digits[i] >= INT128_WIN_NBASE) {
+      return 1;
+    }
+    // Fractional digits are only accepted when zero.
+    if (i > weight && 0 != digits[i]) {
+      return 1;
+    }
+  }
+  uint128_win result = { .low = 0, .high = 0 };
+  if (0 == ndigits) {
+    *value_out = result;
+    return 0;
+  }
+  if (weight >= INT128_WIN_NBASE_DIGITS_MAX) {
+    return 1;
+  }
+
+  // Collects up to 4 digits into a 64-bit chunk before touching
+  // the 128-bit accumulator.
+  uint64_t chunk = 0;
+  uint64_t multiplier = 1;
+  for (int i = 0; i <= weight; i++) {
+    chunk = chunk * INT128_WIN_NBASE + (i < ndigits ? (uint64_t) digits[i] : 0);
+    multiplier *= INT128_WIN_NBASE;
+    if (3 == i % 4 || i == weight) {
+      uint128_win umultiplier = { .low = multiplier, .high = 0 };
+      if (0 != uint128_win_multiply_checked(result, umultiplier, &result)) {
+        return 1;
+      }
+      uint64_t high = 0;
+      unsigned char carry = _addcarry_u64(0, result.low, chunk, &result.low);
+      if (_addcarry_u64(carry, result.high, 0, &high)) {
+        return 1;
+      }
+      result.high = high;
+      chunk = 0;
+      multiplier = 1;
+    }
+  }
+  *value_out = result;
+  return 0;
+}
+
+static inline int int128_win_from_nbase_digits(const int16_t* digits, int ndigits, int weight, int sign, int128_win* value_out) {
+  if (NULL == value_out) {
+    return -1;
+  }
+  if (INT128_WIN_NBASE_POS != sign && INT128_WIN_NBASE_NEG != sign) {
+    return 1;
+  }
+  uint128_win uvalue = { .low = 0, .high = 0 };
+  int err = uint128_win_from_nbase_digits(digits, ndigits, weight, &uvalue);
+  if (0 != err) {
+    return err;
+  }
+  const uint128_win min_abs = { .low = 0, .high = ((uint64_t) 1) << 63 };
+  int cmp = uint128_win_compare(uvalue, min_abs);
+  if (cmp > 0 || (0 == cmp && INT128_WIN_NBASE_POS == sign)) {
+    return 1;
+  }
+  if (INT128_WIN_NBASE_NEG == sign) {
+    uvalue = uint128_win_negate(uvalue);
+  }
+  *value_out = (int128_win) { .low = uvalue.low, .high = int128_win_bitcast_to_signed(uvalue.high) };
+  return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INT128_WIN_INT128_WIN_NBASE_H
\ No newline at end of file
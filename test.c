@@ -16,6 +16,8 @@
 
 #include "uint128_win.h"
 #include "int128_win.h"
+#include "int128_win_for.h"
+#include "int128_win_nbase.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -297,6 +299,91 @@ void test_shift_right() {
   int128_assert(0 == uint128_win_compare(uint128_win_shift_right(max, 127), one));
 }
 
+void test_gcd() {
+  const uint128_win six = {.low = 6, .high = 0};
+  const uint128_win nine = {.low = 9, .high = 0};
+  const uint128_win three = {.low = 3, .high = 0};
+  const uint128_win big1 = {.low = 2, .high = 3};
+  const uint128_win big2 = {.low = 5, .high = 7};
+  const uint128_win big_dividend = {.low = 18, .high = 27};
+  const uint128_win big_pow2 = {.low = 0, .high = 1ULL << 20};
+  const uint128_win big_pow2_odd = {.low = 3ULL << 10, .high = 3ULL << 20};
+
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(zero, zero), zero));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(zero, two), two));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(max, zero), max));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(one, max), one));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(six, nine), three));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(four, six), two));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(max, max), max));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(low_max, high_one), one));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(high_max, high_one), high_one));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(big_dividend, big1), big1));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(big_dividend, nine), nine));
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(big1, big2), one));
+  const uint128_win big_pow2_gcd = {.low = 1ULL << 10, .high = 0};
+  int128_assert(0 == uint128_win_compare(uint128_win_gcd(big_pow2, big_pow2_odd), big_pow2_gcd));
+}
+
+void test_lcm() {
+  const uint128_win six = {.low = 6, .high = 0};
+  const uint128_win nine = {.low = 9, .high = 0};
+  const uint128_win eighteen = {.low = 18, .high = 0};
+  const uint128_win big1 = {.low = 2, .high = 3};
+  const uint128_win big2 = {.low = 5, .high = 7};
+  uint128_win result = zero;
+
+  int128_assert(-1 == uint128_win_lcm(one, one, NULL));
+  int128_assert(0 == uint128_win_lcm(zero, max, &result));
+  int128_assert(0 == uint128_win_compare(result, zero));
+  int128_assert(0 == uint128_win_lcm(six, nine, &result));
+  int128_assert(0 == uint128_win_compare(result, eighteen));
+  int128_assert(0 == uint128_win_lcm(max, one, &result));
+  int128_assert(0 == uint128_win_compare(result, max));
+  int128_assert(0 == uint128_win_lcm(low_max, high_one, &result));
+  int128_assert(0 == uint128_win_compare(result, high_max));
+  int128_assert(0 == uint128_win_lcm(max, max, &result));
+  int128_assert(0 == uint128_win_compare(result, max));
+  int128_assert(1 == uint128_win_lcm(max, two, &result));
+  int128_assert(1 == uint128_win_lcm(big1, big2, &result));
+  int128_assert(1 == uint128_win_lcm(high_one, (uint128_win) {.low = 3, .high = 1}, &result));
+}
+
+void test_inplace() {
+  const uint128_win big1 = {.low = 2, .high = 3};
+  const uint128_win big2 = {.low = 9, .high = 0};
+  const uint128_win rem_dividend = {.low = 20, .high = 27};
+  uint128_win acc = zero;
+  uint128_win remainder = zero;
+
+  uint128_win_add_inplace(&acc, &low_max);
+  int128_assert(0 == uint128_win_compare(acc, low_max));
+  uint128_win_add_inplace(&acc, &one);
+  int128_assert(0 == uint128_win_compare(acc, high_one));
+  uint128_win_subtract_inplace(&acc, &one);
+  int128_assert(0 == uint128_win_compare(acc, low_max));
+  acc = zero;
+  uint128_win_subtract_inplace(&acc, &one);
+  int128_assert(0 == uint128_win_compare(acc, max));
+  uint128_win_add_inplace(&acc, &one);
+  int128_assert(0 == uint128_win_compare(acc, zero));
+
+  acc = big1;
+  uint128_win_multiply_inplace(&acc, &big2);
+  int128_assert(0 == uint128_win_compare(acc, uint128_win_multiply(big1, big2)));
+  acc = max;
+  uint128_win_multiply_inplace(&acc, &two);
+  int128_assert(0 == uint128_win_compare(acc, uint128_win_multiply(max, two)));
+
+  acc = rem_dividend;
+  uint128_win_divide_inplace(&acc, &big2, &remainder);
+  int128_assert(0 == uint128_win_compare(acc, big1));
+  int128_assert(0 == uint128_win_compare(remainder, two));
+  acc = four;
+  uint128_win_divide_inplace(&acc, &two, NULL);
+  int128_assert(0 == uint128_win_compare(acc, two));
+}
+
 void test_compare_signed() {
   int128_win signed_zero = int128_win_create(zero);
   int128_win signed_one = int128_win_create(one);
@@ -436,6 +523,415 @@ void test_divide_signed() {
   int128_assert(0 == int128_win_compare(minus_remainder, minus_two));
 }
 
+void test_gcd_signed() {
+  int128_win signed_zero = int128_win_create(zero);
+  int128_win signed_two = int128_win_create(two);
+  int128_win minus_two = int128_win_create_negative(two);
+  int128_win minus_four = int128_win_create_negative(four);
+  int128_win signed_high_one = int128_win_create(high_one);
+  int128_win minus_high_one = int128_win_create_negative(high_one);
+  const uint128_win min_abs = {.low = 0, .high = 1ULL << 63};
+  int128_win signed_min = int128_win_create_negative(min_abs);
+
+  int128_assert(0 == uint128_win_compare(int128_win_gcd(signed_zero, signed_zero), zero));
+  int128_assert(0 == uint128_win_compare(int128_win_gcd(minus_two, signed_zero), two));
+  int128_assert(0 == uint128_win_compare(int128_win_gcd(minus_four, minus_two), two));
+  int128_assert(0 == uint128_win_compare(int128_win_gcd(minus_four, signed_two), two));
+  int128_assert(0 == uint128_win_compare(int128_win_gcd(minus_high_one, signed_high_one), high_one));
+  int128_assert(0 == uint128_win_compare(int128_win_gcd(signed_min, signed_zero), min_abs));
+  int128_assert(0 == uint128_win_compare(int128_win_gcd(signed_min, minus_high_one), high_one));
+}
+
+void test_lcm_signed() {
+  int128_win signed_zero = int128_win_create(zero);
+  int128_win signed_two = int128_win_create(two);
+  int128_win minus_two = int128_win_create_negative(two);
+  int128_win signed_four = int128_win_create(four);
+  int128_win minus_four = int128_win_create_negative(four);
+  int128_win signed_high_one = int128_win_create(high_one);
+  int128_win minus_low_max = int128_win_create_negative(low_max);
+  int128_win minus_high_one = int128_win_create_negative(high_one);
+  const uint128_win min_abs = {.low = 0, .high = 1ULL << 63};
+  int128_win signed_min = int128_win_create_negative(min_abs);
+  int128_win result = signed_zero;
+
+  int128_assert(-1 == int128_win_lcm(signed_two, signed_two, NULL));
+  int128_assert(0 == int128_win_lcm(signed_zero, minus_two, &result));
+  int128_assert(0 == int128_win_compare(result, signed_zero));
+  int128_assert(0 == int128_win_lcm(minus_two, minus_four, &result));
+  int128_assert(0 == int128_win_compare(result, signed_four));
+  int128_assert(0 == int128_win_lcm(minus_four, signed_two, &result));
+  int128_assert(0 == int128_win_compare(result, signed_four));
+  int128_assert(1 == int128_win_lcm(signed_high_one, minus_low_max, &result));
+  int128_assert(1 == int128_win_lcm(signed_min, signed_two, &result));
+  int128_assert(0 == int128_win_lcm(minus_high_one, minus_two, &result));
+  int128_assert(0 == int128_win_compare(result, signed_high_one));
+}
+
+void test_mul_add_int64() {
+  int128_win signed_zero = int128_win_create(zero);
+  int128_win signed_one = int128_win_create(one);
+  int128_win minus_one = int128_win_create_negative(one);
+  int128_win signed_low_max = int128_win_create(low_max);
+  const uint128_win int64_max_square = {.low = 1, .high = (UINT64_MAX >> 2)};
+  const uint128_win int64_min_square = {.low = 0, .high = 1ULL << 62};
+  const uint128_win int128_max = {.low = UINT64_MAX, .high = UINT64_MAX >> 1};
+  const uint128_win min_abs = {.low = 0, .high = 1ULL << 63};
+  int128_win result = signed_zero;
+
+  int128_assert(0 == int128_win_compare(int128_win_mul_add_int64(signed_zero, 0, INT64_MAX), signed_zero));
+  int128_assert(0 == int128_win_compare(int128_win_mul_add_int64(signed_zero, -1, 1), minus_one));
+  int128_assert(0 == int128_win_compare(int128_win_mul_add_int64(minus_one, -1, -2), signed_one));
+  int128_assert(0 == int128_win_compare(int128_win_mul_add_int64(minus_one, 1, 1), signed_zero));
+  int128_assert(0 == int128_win_compare(int128_win_mul_add_int64(signed_low_max, -1, 1), int128_win_create(
+      (uint128_win) {.low = UINT64_MAX - 1, .high = 0})));
+  int128_assert(0 == int128_win_compare(int128_win_mul_add_int64(signed_zero, INT64_MAX, INT64_MAX),
+      int128_win_create(int64_max_square)));
+  int128_assert(0 == int128_win_compare(int128_win_mul_add_int64(signed_zero, INT64_MIN, INT64_MIN),
+      int128_win_create(int64_min_square)));
+  int128_assert(0 == int128_win_compare(int128_win_mul_add_int64(signed_zero, INT64_MIN, INT64_MAX),
+      int128_win_create_negative(uint128_win_subtract(int64_min_square, (uint128_win) {.low = 1ULL << 63, .high = 0}))));
+
+  int128_assert(-1 == int128_win_mul_add_int64_checked(signed_zero, 1, 1, NULL));
+  int128_assert(0 == int128_win_mul_add_int64_checked(minus_one, 2, 3, &result));
+  int128_assert(0 == int128_win_compare(result, int128_win_from_int64(5)));
+  int128_assert(1 == int128_win_mul_add_int64_checked(int128_win_create(int128_max), 1, 1, &result));
+  int128_assert(0 == int128_win_mul_add_int64_checked(int128_win_create(int128_max), -1, 1, &result));
+  int128_assert(1 == int128_win_mul_add_int64_checked(int128_win_create_negative(min_abs), -1, 1, &result));
+  int128_assert(0 == int128_win_mul_add_int64_checked(int128_win_create_negative(min_abs), 1, 1, &result));
+}
+
+void test_dot_int64() {
+  const int64_t left[] = { 1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11 };
+  const int64_t right[] = { 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+  const int64_t max_left[] = { INT64_MIN, INT64_MIN, INT64_MIN };
+  const int64_t max_right[] = { INT64_MIN, INT64_MIN, INT64_MAX };
+  const int64_t min_right[] = { INT64_MAX, INT64_MAX, INT64_MAX };
+  const uint128_win int64_min_square = {.low = 0, .high = 1ULL << 62};
+  int128_win result = int128_win_from_int64(0);
+
+  int128_assert(0 == int128_win_compare(int128_win_dot_int64(NULL, NULL, 0), int128_win_from_int64(0)));
+  int128_assert(0 == int128_win_compare(int128_win_dot_int64(left, right, 1), int128_win_from_int64(11)));
+  int128_assert(0 == int128_win_compare(int128_win_dot_int64(left, right, 4), int128_win_from_int64(-14)));
+  int128_assert(0 == int128_win_compare(int128_win_dot_int64(left, right, 11), int128_win_from_int64(6)));
+  int128_assert(0 == int128_win_compare(int128_win_dot_int64(max_left, max_left, 2),
+      int128_win_create(uint128_win_shift_left(int64_min_square, 1))));
+
+  int128_assert(-1 == int128_win_dot_int64_checked(left, right, 11, NULL));
+  int128_assert(-1 == int128_win_dot_int64_checked(NULL, right, 11, &result));
+  int128_assert(0 == int128_win_dot_int64_checked(NULL, NULL, 0, &result));
+  int128_assert(0 == int128_win_compare(result, int128_win_from_int64(0)));
+  int128_assert(0 == int128_win_dot_int64_checked(left, right, 11, &result));
+  int128_assert(0 == int128_win_compare(result, int128_win_from_int64(6)));
+  // 2^126 + 2^126 overflows the partial sum, final sum is 2^126 + 2^63
+  int128_assert(0 == int128_win_dot_int64_checked(max_left, max_right, 3, &result));
+  int128_assert(0 == int128_win_compare(result, int128_win_create(
+      (uint128_win) {.low = 1ULL << 63, .high = 1ULL << 62})));
+  int128_assert(1 == int128_win_dot_int64_checked(max_left, max_left, 2, &result));
+  int128_assert(1 == int128_win_dot_int64_checked(max_left, min_right, 3, &result));
+  int128_assert(0 == int128_win_dot_int64_checked(max_left, min_right, 2, &result));
+  int128_assert(0 == int128_win_compare(result, int128_win_create_negative(
+      (uint128_win) {.low = 0, .high = UINT64_MAX >> 1})));
+}
+
+void test_inplace_signed() {
+  int128_win signed_zero = int128_win_create(zero);
+  int128_win signed_one = int128_win_create(one);
+  int128_win minus_one = int128_win_create_negative(one);
+  int128_win signed_two = int128_win_create(two);
+  int128_win minus_two = int128_win_create_negative(two);
+  int128_win signed_low_max = int128_win_create(low_max);
+  int128_win signed_high_one = int128_win_create(high_one);
+  int128_win minus_high_one = int128_win_create_negative(high_one);
+  const uint128_win big1 = {.low = 2, .high = 3};
+  int128_win minus_big1 = int128_win_create_negative(big1);
+  const uint128_win big2 = {.low = 9, .high = 0};
+  int128_win signed_big2 = int128_win_create(big2);
+  const uint128_win rem_dividend = {.low = 20, .high = 27};
+  int128_win minus_rem_dividend = int128_win_create_negative(rem_dividend);
+  int128_win acc = signed_zero;
+  int128_win remainder = signed_zero;
+
+  int128_win_add_inplace(&acc, &minus_one);
+  int128_assert(0 == int128_win_compare(acc, minus_one));
+  int128_win_add_inplace(&acc, &signed_two);
+  int128_assert(0 == int128_win_compare(acc, signed_one));
+  int128_win_add_inplace(&acc, &signed_low_max);
+  int128_assert(0 == int128_win_compare(acc, signed_high_one));
+  int128_win_subtract_inplace(&acc, &signed_low_max);
+  int128_assert(0 == int128_win_compare(acc, signed_one));
+  int128_win_subtract_inplace(&acc, &signed_two);
+  int128_assert(0 == int128_win_compare(acc, minus_one));
+
+  acc = signed_one;
+  int128_win_add_int64_inplace(&acc, -2);
+  int128_assert(0 == int128_win_compare(acc, minus_one));
+  int128_win_add_int64_inplace(&acc, INT64_MIN);
+  int128_win_add_int64_inplace(&acc, INT64_MIN);
+  int128_win_add_int64_inplace(&acc, 1);
+  int128_assert(0 == int128_win_compare(acc, minus_high_one));
+  acc = signed_low_max;
+  int128_win_add_int64_inplace(&acc, 1);
+  int128_assert(0 == int128_win_compare(acc, signed_high_one));
+
+  acc = minus_big1;
+  int128_win_multiply_inplace(&acc, &signed_big2);
+  int128_assert(0 == int128_win_compare(acc, int128_win_multiply(minus_big1, signed_big2)));
+  acc = minus_two;
+  int128_win_multiply_inplace(&acc, &minus_one);
+  int128_assert(0 == int128_win_compare(acc, signed_two));
+
+  acc = minus_rem_dividend;
+  int128_win_divide_inplace(&acc, &signed_big2, &remainder);
+  int128_assert(0 == int128_win_compare(acc, minus_big1));
+  int128_assert(0 == int128_win_compare(remainder, minus_two));
+  acc = signed_two;
+  int128_win_divide_inplace(&acc, &minus_two, NULL);
+  int128_assert(0 == int128_win_compare(acc, minus_one));
+}
+
+void test_top_k() {
+  int128_win values[8];
+  values[0] = int128_win_from_int64(5);
+  values[1] = int128_win_create_negative(high_one);
+  values[2] = int128_win_create(high_one);
+  values[3] = int128_win_from_int64(-3);
+  values[4] = int128_win_from_int64(5);
+  values[5] = int128_win_create(low_max);
+  values[6] = int128_win_from_int64(0);
+  values[7] = int128_win_from_int64(-3);
+  int128_win out[8];
+  uint32_t out_idx[8];
+
+  int128_assert(-1 == int128_win_top_k(NULL, 8, 3, true, out, out_idx));
+  int128_assert(-1 == int128_win_top_k(values, 8, 3, true, NULL, out_idx));
+  int128_assert(0 == int128_win_top_k(values, 8, 0, true, NULL, NULL));
+
+  int128_assert(0 == int128_win_top_k(values, 8, 3, true, out, out_idx));
+  int128_assert(0 == int128_win_compare(out[0], int128_win_create(high_one)));
+  int128_assert(2 == out_idx[0]);
+  int128_assert(0 == int128_win_compare(out[1], int128_win_create(low_max)));
+  int128_assert(5 == out_idx[1]);
+  int128_assert(0 == int128_win_compare(out[2], int128_win_from_int64(5)));
+  int128_assert(0 == out_idx[2] || 4 == out_idx[2]);
+
+  int128_assert(0 == int128_win_top_k(values, 8, 2, false, out, NULL));
+  int128_assert(0 == int128_win_compare(out[0], int128_win_create_negative(high_one)));
+  int128_assert(0 == int128_win_compare(out[1], int128_win_from_int64(-3)));
+
+  int128_assert(0 == int128_win_top_k(values, 8, 20, false, out, out_idx));
+  for (size_t i = 1; i < 8; i++) {
+    int128_assert(int128_win_compare(out[i - 1], out[i]) <= 0);
+    int128_assert(0 == int128_win_compare(out[i], values[out_idx[i]]));
+  }
+}
+
+void test_nth_element() {
+  int128_win values[200];
+  int128_win sorted[200];
+  uint64_t seed = 42;
+  for (size_t i = 0; i < 200; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    // Few distinct high words with duplicates to exercise partitioning
+    values[i] = (int128_win) { .low = seed >> 60, .high = ((int64_t) (seed >> 32) % 5) - 2 };
+    sorted[i] = values[i];
+  }
+  int128_win_insertion_sort(sorted, 200);
+
+  int128_assert(-1 == int128_win_nth_element(NULL, 200, 0));
+  int128_assert(-1 == int128_win_nth_element(values, 200, 200));
+
+  const size_t positions[] = { 0, 1, 50, 99, 100, 150, 198, 199 };
+  for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+    size_t nth = positions[i];
+    int128_assert(0 == int128_win_nth_element(values, 200, nth));
+    int128_assert(0 == int128_win_compare(values[nth], sorted[nth]));
+    for (size_t j = 0; j < nth; j++) {
+      int128_assert(int128_win_compare(values[j], values[nth]) <= 0);
+    }
+    for (size_t j = nth + 1; j < 200; j++) {
+      int128_assert(int128_win_compare(values[j], values[nth]) >= 0);
+    }
+  }
+
+  int128_win single = int128_win_from_int64(-1);
+  int128_assert(0 == int128_win_nth_element(&single, 1, 0));
+  int128_assert(0 == int128_win_compare(single, int128_win_from_int64(-1)));
+}
+
+static void check_for_roundtrip(const int128_win* values, size_t count, int expected_width) {
+  static uint64_t packed[INT128_WIN_FOR_PACKED_WORDS_MAX];
+  static int128_win decoded[INT128_WIN_FOR_BLOCK_SIZE];
+  int128_win_for_block block;
+
+  int128_assert(0 == int128_win_for_encode(values, count, &block, packed));
+  int128_assert(count == block.count);
+  int128_assert(expected_width == (int) block.width);
+  int128_assert(0 == int128_win_for_decode(&block, packed, decoded));
+  for (size_t i = 0; i < count; i++) {
+    int128_assert(0 == int128_win_compare(decoded[i], values[i]));
+    int128_assert(0 == int128_win_compare(int128_win_for_get(&block, packed, i), values[i]));
+  }
+}
+
+void test_for_encode_decode() {
+  static int128_win values[INT128_WIN_FOR_BLOCK_SIZE + 1];
+  static uint64_t packed[INT128_WIN_FOR_PACKED_WORDS_MAX];
+  int128_win_for_block block;
+  const uint128_win min_abs = {.low = 0, .high = 1ULL << 63};
+  const uint128_win int128_max = {.low = UINT64_MAX, .high = UINT64_MAX >> 1};
+
+  int128_assert(-1 == int128_win_for_encode(NULL, 1, &block, packed));
+  int128_assert(-1 == int128_win_for_encode(values, 1, NULL, packed));
+  int128_assert(-1 == int128_win_for_decode(&block, packed, NULL));
+  int128_assert(1 == int128_win_for_encode(values, INT128_WIN_FOR_BLOCK_SIZE + 1, &block, packed));
+  check_for_roundtrip(values, 0, 0);
+
+  for (size_t i = 0; i < INT128_WIN_FOR_BLOCK_SIZE; i++) {
+    values[i] = int128_win_create_negative(high_one);
+  }
+  check_for_roundtrip(values, INT128_WIN_FOR_BLOCK_SIZE, 0);
+
+  uint64_t seed = 42;
+  for (size_t i = 0; i < INT128_WIN_FOR_BLOCK_SIZE; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    values[i] = int128_win_from_int64(-1000 + (int64_t) (seed >> 54));
+  }
+  values[7] = int128_win_from_int64(-1000 + 1023);
+  check_for_roundtrip(values, INT128_WIN_FOR_BLOCK_SIZE, 10);
+  check_for_roundtrip(values, 13, 10);
+
+  for (size_t i = 0; i < INT128_WIN_FOR_BLOCK_SIZE; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    values[i] = int128_win_add(int128_win_create(low_max), int128_win_from_int64((int64_t) (seed >> 1)));
+  }
+  values[0] = int128_win_create(low_max);
+  values[1] = int128_win_add(int128_win_create(low_max), int128_win_from_int64(INT64_MAX));
+  check_for_roundtrip(values, INT128_WIN_FOR_BLOCK_SIZE, 63);
+  values[1] = int128_win_create(uint128_win_add(low_max, low_max));
+  check_for_roundtrip(values, INT128_WIN_FOR_BLOCK_SIZE, 64);
+
+  for (size_t i = 0; i < INT128_WIN_FOR_BLOCK_SIZE; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    values[i] = (int128_win) { .low = seed, .high = -((int64_t) (seed >> 45)) };
+  }
+  values[0] = (int128_win) { .low = 0, .high = -(1LL << 19) };
+  values[1] = (int128_win) { .low = UINT64_MAX, .high = 0 };
+  check_for_roundtrip(values, INT128_WIN_FOR_BLOCK_SIZE, 84);
+  check_for_roundtrip(values, 5, 84);
+
+  values[2] = int128_win_create_negative(min_abs);
+  values[3] = int128_win_create(int128_max);
+  check_for_roundtrip(values, INT128_WIN_FOR_BLOCK_SIZE, 128);
+
+  // Every packed width, count is not a multiple of 4 to cover both SIMD and scalar unpacking
+  for (int width = 1; width <= 64; width++) {
+    uint64_t mask = width < 64 ? (1ULL << width) - 1 : UINT64_MAX;
+    for (size_t i = 0; i < INT128_WIN_FOR_BLOCK_SIZE - 3; i++) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      values[i] = int128_win_add(int128_win_create_negative(high_one), int128_win_create(
+          (uint128_win) {.low = seed & mask, .high = 0}));
+    }
+    values[0] = int128_win_create_negative(high_one);
+    values[1] = int128_win_add(values[0], int128_win_create((uint128_win) {.low = mask, .high = 0}));
+    check_for_roundtrip(values, INT128_WIN_FOR_BLOCK_SIZE - 3, width);
+  }
+}
+
+static bool nbase_digits_equal(const int16_t* left, int left_count, const int16_t* right, int right_count) {
+  if (left_count != right_count) {
+    return false;
+  }
+  for (int i = 0; i < left_count; i++) {
+    if (left[i] != right[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void test_to_nbase_digits() {
+  int16_t digits[INT128_WIN_NBASE_DIGITS_MAX];
+  int ndigits = -1;
+  int weight = -1;
+  int sign = -1;
+  const int16_t max_digits[] = { 340, 2823, 6692, 938, 4634, 6337, 4607, 4317, 6821, 1455 };
+  const int16_t min_digits[] = { 170, 1411, 8346, 469, 2317, 3168, 7303, 7158, 8410, 5728 };
+  const int16_t chunked_digits[] = { 1, 2345, 6789 };
+  const int16_t one_digits[] = { 1 };
+  const uint128_win min_abs = {.low = 0, .high = 1ULL << 63};
+  // 10^32
+  const uint128_win pow_32 = {.low = 0x85acef8100000000ULL, .high = 0x4ee2d6d415bULL};
+
+  int128_assert(-1 == uint128_win_to_nbase_digits(one, NULL, &ndigits, &weight));
+  int128_assert(-1 == int128_win_to_nbase_digits(int128_win_create(one), digits, &ndigits, &weight, NULL));
+
+  int128_assert(0 == uint128_win_to_nbase_digits(zero, digits, &ndigits, &weight));
+  int128_assert(0 == ndigits && 0 == weight);
+  int128_assert(0 == uint128_win_to_nbase_digits(one, digits, &ndigits, &weight));
+  int128_assert(nbase_digits_equal(digits, ndigits, one_digits, 1) && 0 == weight);
+  int128_assert(0 == uint128_win_to_nbase_digits((uint128_win) {.low = 10000, .high = 0}, digits, &ndigits, &weight));
+  int128_assert(nbase_digits_equal(digits, ndigits, one_digits, 1) && 1 == weight);
+  int128_assert(0 == uint128_win_to_nbase_digits((uint128_win) {.low = 12345678900000000ULL, .high = 0},
+      digits, &ndigits, &weight));
+  int128_assert(nbase_digits_equal(digits, ndigits, chunked_digits, 3) && 4 == weight);
+  int128_assert(0 == uint128_win_to_nbase_digits(pow_32, digits, &ndigits, &weight));
+  int128_assert(nbase_digits_equal(digits, ndigits, one_digits, 1) && 8 == weight);
+  int128_assert(0 == uint128_win_to_nbase_digits(max, digits, &ndigits, &weight));
+  int128_assert(nbase_digits_equal(digits, ndigits, max_digits, 10) && 9 == weight);
+
+  int128_assert(0 == int128_win_to_nbase_digits(int128_win_from_int64(0), digits, &ndigits, &weight, &sign));
+  int128_assert(0 == ndigits && 0 == weight && INT128_WIN_NBASE_POS == sign);
+  int128_assert(0 == int128_win_to_nbase_digits(int128_win_from_int64(-10000), digits, &ndigits, &weight, &sign));
+  int128_assert(nbase_digits_equal(digits, ndigits, one_digits, 1) && 1 == weight && INT128_WIN_NBASE_NEG == sign);
+  int128_assert(0 == int128_win_to_nbase_digits(int128_win_create_negative(min_abs), digits, &ndigits, &weight, &sign));
+  int128_assert(nbase_digits_equal(digits, ndigits, min_digits, 10) && 9 == weight && INT128_WIN_NBASE_NEG == sign);
+}
+
+void test_from_nbase_digits() {
+  const int16_t max_digits[] = { 340, 2823, 6692, 938, 4634, 6337, 4607, 4317, 6821, 1455 };
+  const int16_t min_digits[] = { 170, 1411, 8346, 469, 2317, 3168, 7303, 7158, 8410, 5728 };
+  const int16_t overflow_digits[] = { 340, 2823, 6692, 938, 4634, 6337, 4607, 4317, 6821, 1456 };
+  const int16_t padded_digits[] = { 0, 1, 2345, 6789, 0, 0 };
+  const int16_t fraction_digits[] = { 1, 2345, 6789, 1 };
+  const int16_t invalid_digits[] = { 1, 10000 };
+  const uint128_win min_abs = {.low = 0, .high = 1ULL << 63};
+  const uint128_win int128_max = {.low = UINT64_MAX, .high = UINT64_MAX >> 1};
+  uint128_win result = zero;
+  int128_win signed_result = int128_win_from_int64(0);
+
+  int128_assert(-1 == uint128_win_from_nbase_digits(NULL, 1, 0, &result));
+  int128_assert(-1 == uint128_win_from_nbase_digits(max_digits, 10, 9, NULL));
+
+  int128_assert(0 == uint128_win_from_nbase_digits(NULL, 0, 0, &result));
+  int128_assert(0 == uint128_win_compare(result, zero));
+  int128_assert(0 == uint128_win_from_nbase_digits(max_digits, 10, 9, &result));
+  int128_assert(0 == uint128_win_compare(result, max));
+  int128_assert(0 == uint128_win_from_nbase_digits(padded_digits, 6, 3, &result));
+  int128_assert(0 == uint128_win_compare(result, (uint128_win) {.low = 123456789, .high = 0}));
+  int128_assert(0 == uint128_win_from_nbase_digits(padded_digits + 1, 3, 4, &result));
+  int128_assert(0 == uint128_win_compare(result, (uint128_win) {.low = 12345678900000000ULL, .high = 0}));
+  int128_assert(1 == uint128_win_from_nbase_digits(fraction_digits, 4, 2, &result));
+  int128_assert(1 == uint128_win_from_nbase_digits(invalid_digits, 2, 1, &result));
+  int128_assert(1 == uint128_win_from_nbase_digits(max_digits, 10, 10, &result));
+  int128_assert(1 == uint128_win_from_nbase_digits(overflow_digits, 10, 9, &result));
+
+  int128_assert(1 == int128_win_from_nbase_digits(min_digits, 10, 9, 0xC000, &signed_result));
+  int128_assert(0 == int128_win_from_nbase_digits(min_digits, 10, 9, INT128_WIN_NBASE_NEG, &signed_result));
+  int128_assert(0 == int128_win_compare(signed_result, int128_win_create_negative(min_abs)));
+  int128_assert(1 == int128_win_from_nbase_digits(min_digits, 10, 9, INT128_WIN_NBASE_POS, &signed_result));
+  int128_assert(0 == int128_win_from_nbase_digits(padded_digits, 6, 3, INT128_WIN_NBASE_NEG, &signed_result));
+  int128_assert(0 == int128_win_compare(signed_result, int128_win_from_int64(-123456789)));
+
+  int16_t digits[INT128_WIN_NBASE_DIGITS_MAX];
+  int ndigits = 0;
+  int weight = 0;
+  int sign = 0;
+  int128_assert(0 == int128_win_to_nbase_digits(int128_win_create(int128_max), digits, &ndigits, &weight, &sign));
+  int128_assert(0 == int128_win_from_nbase_digits(digits, ndigits, weight, sign, &signed_result));
+  int128_assert(0 == int128_win_compare(signed_result, int128_win_create(int128_max)));
+}
+
 int main() {
 
   test_from_hex();
@@ -447,12 +943,25 @@ int main() {
   test_divide();
   test_shift_left();
   test_shift_right();
+  test_gcd();
+  test_lcm();
+  test_inplace();
 
   test_compare_signed();
   test_add_signed();
   test_subtract_signed();
   test_multiply_signed();
   test_divide_signed();
+  test_gcd_signed();
+  test_lcm_signed();
+  test_mul_add_int64();
+  test_dot_int64();
+  test_inplace_signed();
+  test_top_k();
+  test_nth_element();
+  test_for_encode_decode();
+  test_to_nbase_digits();
+  test_from_nbase_digits();
 
   return 0;
 }
\ No newline at end of file
@@ -29,6 +29,9 @@ extern "C" {
 
 #define INT128_WIN_HEX_STR_SIZE 35
 
+// In-place functions expect that their pointer arguments do not alias.
+#define INT128_WIN_RESTRICT __restrict
+
 typedef struct uint128_win {
   uint64_t low;  
   uint64_t high;  
@@ -72,6 +75,21 @@ static inline int uint128_win_count_leading_zeros(uint64_t value) {
   return 64;
 }
 
+static inline int uint128_win_count_trailing_zeros(uint64_t value) {
+  unsigned long result = 0;
+  if (_BitScanForward64(&result, value)) {
+    return result;
+  }
+  return 64;
+}
+
+static inline int uint128_win_first_set_bit_pos(uint128_win value) {
+  if (value.low > 0) {
+    return uint128_win_count_trailing_zeros(value.low);
+  }
+  return 64 + uint128_win_count_trailing_zeros(value.high);
+}
+
 static inline int uint128_win_last_set_bit_pos(uint128_win value) {
   if (value.high > 0) {
     return 127 - uint128_win_count_leading_zeros(value.high);
@@ -194,6 +212,113 @@ static inline uint128_win uint128_win_divide(uint128_win dividend, uint128_win d
   return quotient;
 }
 
+static inline void uint128_win_add_inplace(uint128_win* INT128_WIN_RESTRICT acc, const uint128_win* INT128_WIN_RESTRICT value) {
+  unsigned char carry = _addcarry_u64(0, acc->low, value->low, &acc->low);
+  _addcarry_u64(carry, acc->high, value->high, &acc->high);
+}
+
+static inline void uint128_win_subtract_inplace(uint128_win* INT128_WIN_RESTRICT acc, const uint128_win* INT128_WIN_RESTRICT value) {
+  unsigned char borrow = _subborrow_u64(0, acc->low, value->low, &acc->low);
+  _subborrow_u64(borrow, acc->high, value->high, &acc->high);
+}
+
+static inline void uint128_win_multiply_inplace(uint128_win* INT128_WIN_RESTRICT acc, const uint128_win* INT128_WIN_RESTRICT value) {
+  uint64_t carry = 0;
+  uint64_t low = _umul128(acc->low, value->low, &carry);
+  acc->high = (acc->low * value->high) + (acc->high * value->low) + carry;
+  acc->low = low;
+}
+
+static inline void uint128_win_divide_inplace(uint128_win* INT128_WIN_RESTRICT dividend, const uint128_win* INT128_WIN_RESTRICT divisor,
+    uint128_win* INT128_WIN_RESTRICT remainder) {
+  *dividend = uint128_win_divide(*dividend, *divisor, remainder);
+}
+
+static inline uint128_win uint128_win_gcd(uint128_win left, uint128_win right) {
+  if (0 == left.low && 0 == left.high) {
+    return right;
+  }
+  if (0 == right.low && 0 == right.high) {
+    return left;
+  }
+
+  // Uses Stein's binary algorithm, common power of two is restored at the end.
+  const uint128_win both = { .low = left.low | right.low, .high = left.high | right.high };
+  const int shift = uint128_win_first_set_bit_pos(both);
+  left = uint128_win_shift_right(left, uint128_win_first_set_bit_pos(left));
+
+  // Left operand stays odd, loops on 128-bit values until both
+  // operands fit into a single word.
+  while (left.high > 0 || right.high > 0) {
+    right = uint128_win_shift_right(right, uint128_win_first_set_bit_pos(right));
+    if (1 == uint128_win_compare(left, right)) {
+      uint128_win tmp = left;
+      left = right;
+      right = tmp;
+    }
+    right = uint128_win_subtract(right, left);
+    if (0 == right.low && 0 == right.high) {
+      return uint128_win_shift_left(left, shift);
+    }
+  }
+
+  uint64_t left64 = left.low;
+  uint64_t right64 = right.low;
+  while (right64 > 0) {
+    right64 >>= uint128_win_count_trailing_zeros(right64);
+    if (left64 > right64) {
+      uint64_t tmp = left64;
+      left64 = right64;
+      right64 = tmp;
+    }
+    right64 -= left64;
+  }
+  return uint128_win_shift_left((uint128_win) {.low = left64, .high = 0}, shift);
+}
+
+static inline int uint128_win_multiply_checked(uint128_win left, uint128_win right, uint128_win* result) {
+  if (NULL == result) {
+    return -1;
+  }
+  if (left.high > 0 && right.high > 0) {
+    return 1;
+  }
+  uint64_t carry = 0;
+  uint64_t low = _umul128(left.low, right.low, &carry);
+  uint64_t cross_carry1 = 0;
+  uint64_t cross1 = _umul128(left.low, right.high, &cross_carry1);
+  uint64_t cross_carry2 = 0;
+  uint64_t cross2 = _umul128(left.high, right.low, &cross_carry2);
+  if (cross_carry1 > 0 || cross_carry2 > 0) {
+    return 1;
+  }
+  // At most one of the cross products is non-zero here.
+  uint64_t high = cross1 + cross2 + carry;
+  if (high < carry) {
+    return 1;
+  }
+  *result = (uint128_win) { .low = low, .high = high };
+  return 0;
+}
+
+static inline int uint128_win_lcm(uint128_win left, uint128_win right, uint128_win* result) {
+  if (NULL == result) {
+    return -1;
+  }
+  if ((0 == left.low && 0 == left.high) || (0 == right.low && 0 == right.high)) {
+    *result = (uint128_win) {.low = 0, .high = 0};
+    return 0;
+  }
+  // Divides the smaller operand to keep the shift-subtract loop short.
+  if (1 == uint128_win_compare(left, right)) {
+    uint128_win tmp = left;
+    left = right;
+    right = tmp;
+  }
+  uint128_win gcd = uint128_win_gcd(left, right);
+  uint128_win quotient = uint128_win_divide(left, gcd, NULL);
+  return uint128_win_multiply_checked(quotient, right, result);
+}
 
 #ifdef __cplusplus
 }